@@ -0,0 +1,296 @@
+#!/usr/bin/env python3
+"""Regenerate the token dictionaries in this directory from the seeds.
+
+Usage: python3 dictionaries/mine.py
+
+For each text-format target, every candidate token of the format is
+counted over the seeds in general_evaluation/<target>. Tokens that occur
+in no seed are dropped. The rest are ordered by the number of seeds they
+occur in, then by total occurrences, then alphabetically.
+"""
+
+import collections
+import os
+import re
+import zlib
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SEEDS = os.path.join(ROOT, 'general_evaluation')
+OUT = os.path.dirname(os.path.abspath(__file__))
+
+
+def load(target):
+    d = os.path.join(SEEDS, target)
+    return [open(os.path.join(d, f), 'rb').read().decode('latin1')
+            for f in sorted(os.listdir(d))]
+
+
+def order(toks, seeds, total):
+    return sorted(toks, key=lambda t: (-seeds[t], -total[t], t))
+
+
+def rank(docs, vocab, ci=False):
+    """Count vocab in docs. Identifiers and #directives match whole words."""
+    seeds = collections.Counter()
+    total = collections.Counter()
+    for doc in docs:
+        for tok in vocab:
+            pat = re.escape(tok)
+            if re.match(r'#?\w+$', tok):
+                pat = pat + r'(?!\w)'
+                if tok[0] != '#':
+                    pat = r'(?<!\w)' + pat
+            n = len(re.findall(pat, doc, re.A | (re.I if ci else 0)))
+            if n:
+                seeds[tok] += 1
+                total[tok] += n
+    return order(seeds, seeds, total)
+
+
+def rank_calls(docs, names, ci=False):
+    """Count calls name(...) in docs, not names inside longer identifiers."""
+    seeds = collections.Counter()
+    total = collections.Counter()
+    for doc in docs:
+        for name in names:
+            pat = r'(?<!\w)' + re.escape(name) + r'\s*\('
+            n = len(re.findall(pat, doc, re.A | (re.I if ci else 0)))
+            if n:
+                seeds[name] += 1
+                total[name] += n
+    return order(seeds, seeds, total)
+
+
+def rank_tokens(token_lists, min_seeds=1):
+    """Rank tokens given one token list per seed."""
+    seeds = collections.Counter()
+    total = collections.Counter()
+    for toks in token_lists:
+        total.update(toks)
+        seeds.update(set(toks))
+    return order([t for t in seeds if seeds[t] >= min_seeds], seeds, total)
+
+
+def escape(tok):
+    out = ''
+    for ch in tok:
+        if ch in '"\\':
+            out += '\\' + ch
+        elif 32 <= ord(ch) < 127:
+            out += ch
+        else:
+            out += '\\x%02X' % ord(ch)
+    return out
+
+
+def write(target, groups):
+    lines = [
+        '#',
+        '# Tokens found in general_evaluation/%s, ordered within each'
+        ' group' % target,
+        '# by the number of seeds they occur in, then by total'
+        ' occurrences.',
+        '# Generated by dictionaries/mine.py; do not edit by hand.',
+        '#',
+        '# Usage: afl-fuzz -x dictionaries/%s.dict ...' % target,
+        '#        or -dict=dictionaries/%s.dict with libFuzzer' % target,
+        '#',
+        '',
+    ]
+    for title, toks in groups:
+        if not toks:
+            continue
+        lines.append('# ' + title)
+        lines += ['"%s"' % escape(t) for t in toks]
+        lines.append('')
+    with open(os.path.join(OUT, target + '.dict'), 'w') as f:
+        f.write('\n'.join(lines).rstrip('\n') + '\n')
+
+
+SQL_KEYWORDS = '''
+ABORT ACTION ADD AFTER ALL ALTER ALWAYS ANALYZE AND AS ASC ATTACH
+AUTOINCREMENT BEFORE BEGIN BETWEEN BY CASCADE CASE CAST CHECK COLLATE
+COLUMN COMMIT CONFLICT CONSTRAINT CREATE CROSS CURRENT CURRENT_DATE
+CURRENT_TIME CURRENT_TIMESTAMP DATABASE DEFAULT DEFERRABLE DEFERRED DELETE
+DESC DETACH DISTINCT DO DROP EACH ELSE END ESCAPE EXCEPT EXCLUDE EXCLUSIVE
+EXISTS EXPLAIN FAIL FILTER FIRST FOLLOWING FOR FOREIGN FROM FULL GENERATED
+GLOB GROUP GROUPS HAVING IF IGNORE IMMEDIATE IN INDEX INDEXED INITIALLY
+INNER INSERT INSTEAD INTERSECT INTO IS ISNULL JOIN KEY LAST LEFT LIKE LIMIT
+MATCH MATERIALIZED NATURAL NO NOT NOTHING NOTNULL NULL NULLS OF OFFSET ON OR
+ORDER OTHERS OUTER OVER PARTITION PLAN PRAGMA PRECEDING PRIMARY QUERY RAISE
+RANGE RECURSIVE REFERENCES REGEXP REINDEX RELEASE RENAME REPLACE RESTRICT
+RETURNING RIGHT ROLLBACK ROW ROWS SAVEPOINT SELECT SET TABLE TEMP TEMPORARY
+THEN TIES TO TRANSACTION TRIGGER UNBOUNDED UNION UNIQUE UPDATE USING VACUUM
+VALUES VIEW VIRTUAL WHEN WHERE WINDOW WITH WITHOUT ROWID
+'''.split()
+
+SQL_TYPES = '''
+INT INTEGER TEXT REAL BLOB NUMERIC CHAR VARCHAR BOOLEAN FLOAT DOUBLE
+'''.split()
+
+SQL_FUNCTIONS = '''
+abs changes char coalesce glob hex ifnull instr last_insert_rowid length
+likelihood lower ltrim max min nullif printf quote random randomblob round
+rtrim soundex substr total_changes trim typeof unicode unlikely upper
+zeroblob avg count group_concat sum total date time datetime julianday
+strftime sqlite_version
+'''.split()
+
+SQL_PRAGMAS = '''
+auto_vacuum cache_size cache_spill encoding foreign_keys integrity_check
+journal_mode mmap_size page_size secure_delete synchronous table_info
+user_version wal_checkpoint writable_schema
+'''.split()
+
+
+def sql():
+    docs = load('sql')
+    # Function names count only when called, as a whole word before '('.
+    calls = rank_calls(docs, SQL_FUNCTIONS, ci=True)
+    write('sql', [
+        ('keywords', rank(docs, SQL_KEYWORDS, ci=True)),
+        ('type names', rank(docs, SQL_TYPES, ci=True)),
+        ('functions', [c for c in calls if c.upper() not in SQL_KEYWORDS]),
+        ('pragmas', rank(docs, SQL_PRAGMAS, ci=True)),
+        ('operators and literals', rank(docs, [
+            '||', '<>', '!=', '==', '<=', '>=', '<<', '>>', "''", '*',
+            ':memory:'])),
+    ])
+
+
+JS_KEYWORDS = '''
+break case catch continue debugger default delete do else finally for
+function if in instanceof new return switch this throw try typeof var void
+while with const let class extends super yield null true false undefined
+NaN Infinity arguments
+'''.split()
+
+JS_BUILTINS = '''
+Object Function Array String Boolean Number Math Date RegExp Error TypeError
+RangeError SyntaxError ReferenceError EvalError URIError JSON eval parseInt
+parseFloat isNaN isFinite encodeURI decodeURI encodeURIComponent
+decodeURIComponent escape unescape print prototype constructor length
+toString valueOf call apply bind push pop shift unshift slice splice concat
+join reverse sort indexOf lastIndexOf map filter forEach reduce reduceRight
+some every charAt charCodeAt fromCharCode substring substr split replace
+match search toUpperCase toLowerCase trim stringify parse keys create
+defineProperty defineProperties getOwnPropertyDescriptor
+getOwnPropertyNames getPrototypeOf freeze seal isFrozen isSealed
+preventExtensions hasOwnProperty isPrototypeOf propertyIsEnumerable toFixed
+toExponential toPrecision exec test lastIndex source global ignoreCase
+multiline getTime setTime now floor ceil random max min abs pow sqrt
+'''.split()
+
+JS_OPERATORS = [
+    '===', '!==', '==', '!=', '>>>', '>>', '<<', '<=', '>=', '&&', '||', '++',
+    '--', '+=', '-=', '=>', '/g', '/i', '/m', '\\u', '\\x']
+
+
+def strip_js_comments(doc):
+    doc = re.sub(r'/\*.*?\*/', ' ', doc, flags=re.S)
+    return re.sub(r'(^|\s)//[^\n]*', r'\1', doc)
+
+
+def mujs():
+    # Comments are dropped so that URLs in them do not count as operators.
+    docs = [strip_js_comments(d) for d in load('mujs')]
+    write('mujs', [
+        ('keywords and literals', rank(docs, JS_KEYWORDS)),
+        ('built-in objects and properties', rank(docs, JS_BUILTINS)),
+        ('operators', rank(docs, JS_OPERATORS)),
+    ])
+
+
+C_KEYWORDS = '''
+auto break case char const continue default do double else enum extern
+float for goto if inline int long register restrict return short signed
+sizeof static struct switch typedef union unsigned void volatile while
+_Bool _Complex
+'''.split()
+
+C_PREPROCESSOR = [
+    '#include', '#define', '#undef', '#if', '#ifdef', '#ifndef', '#elif',
+    '#else', '#endif', '#pragma', '#error', '#line', 'defined',
+    '__attribute__', '__asm__', '__inline__', '__extension__']
+
+C_LIBRARY = '''
+NULL EOF FILE size_t main printf fprintf sprintf snprintf scanf malloc
+calloc realloc free memcpy memset strcmp strcpy strlen strcat exit abort
+stdin stdout stderr argc argv va_list va_start va_end assert
+'''.split()
+
+C_OPERATORS = [
+    '->', '++', '--', '<<=', '>>=', '&&', '||', '==', '!=', '...', '/*', '*/',
+    '//', '\\n']
+
+
+def cflow():
+    docs = load('cflow')
+    write('cflow', [
+        ('keywords', rank(docs, C_KEYWORDS)),
+        ('preprocessor and extensions', rank(docs, C_PREPROCESSOR)),
+        ('library identifiers', rank(docs, C_LIBRARY)),
+        ('operators and comments', rank(docs, C_OPERATORS)),
+    ])
+
+
+def json():
+    docs = load('json')
+    write('json', [
+        ('literals', rank(docs, ['true', 'false', 'null'])),
+        ('structure, strings and numbers', rank(docs, [
+            '{', '}', '[', ']', ':', ',', '""', '\\"', '\\\\', '\\/', '\\b',
+            '\\f', '\\n', '\\r', '\\t', '\\u', '-', 'e+', 'E-', '0.'])),
+    ])
+
+
+PDF_STRUCTURE = [
+    '%PDF-1.', '%%EOF', 'obj', 'endobj', 'stream', 'endstream', 'xref',
+    'trailer', 'startxref', 'R', 'true', 'false', 'null', '<<', '>>']
+
+PDF_OPERATORS = set('''
+BT ET Tf Td TD Tm Tj TJ T* Tc Tw TL Tz Tr cm re Do BI ID EI q Q gs cs CS sc
+scn rg RG g G k K w J j d m l c v y h f f* S s B n W W* BDC EMC BMC
+'''.split())
+
+
+def inflate_streams(doc):
+    """Return the inflated content of every stream in doc, joined."""
+    out = []
+    for m in re.finditer(r'stream\r?\n(.*?)endstream', doc, re.S):
+        # decompressobj keeps what it can of truncated streams.
+        try:
+            data = zlib.decompressobj().decompress(m.group(1).encode('latin1'))
+        except zlib.error:
+            continue
+        out.append(data.decode('latin1'))
+    return '\n'.join(out)
+
+
+def pdf():
+    docs = load('pdf')
+    # Common names only, and not numbered resource names such as /R7,
+    # /F1, /GS0 or /Im3. Standard names like /Type1 and /FontFile3 stay.
+    names = rank_tokens(
+        [[n for n in re.findall(r'/[A-Z][A-Za-z0-9]+', d)
+          if not re.match(r'/[A-Z][A-Za-z]?\d+$', n)]
+         for d in docs], min_seeds=10)
+    # Content operators are counted per seed over all of its inflated
+    # streams, as whitespace- or delimiter-separated tokens.
+    operators = rank_tokens(
+        [[t for t in re.split(r'[\s\[\]()<>/{}]+', inflate_streams(d),
+                              flags=re.A)
+          if t in PDF_OPERATORS] for d in docs])
+    write('pdf', [
+        ('file structure', rank(docs, PDF_STRUCTURE)),
+        ('names', names),
+        ('content stream operators', operators),
+    ])
+
+
+if __name__ == '__main__':
+    sql()
+    mujs()
+    cflow()
+    json()
+    pdf()